@@ -0,0 +1,425 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <thread>
+
+#include "analytics.h"
+#include "board.h"
+#include "patterns.h"
+#include "workers.h"
+
+// Boards handed to a batch worker at a time.
+static const int kBatchChunkSize = 256;
+
+/*
+ * Returns the root of a cell in the union-find forest, halving paths on the
+ * way up.
+ */
+static int findRoot(std::vector<int> &parent, int index) {
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+static void unite(std::vector<int> &parent, int a, int b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a != b) parent[std::max(a, b)] = std::min(a, b);
+}
+
+/*
+ * State of one simulated game. Revealed numbered cells whose hidden
+ * neighborhood changed are queued for another look, so each deduction step
+ * only touches the cells around what just changed.
+ */
+struct GuessSimulation {
+    GuessSimulation(const std::vector<unsigned char> &board, int numRows,
+                    int numCols)
+        : board(board),
+        numRows(numRows),
+        numCols(numCols),
+        revealed(board.size(), 0),
+        knownMine(board.size(), 0),
+        queued(board.size(), 0) {}
+
+    const std::vector<unsigned char> &board;
+    int numRows;
+    int numCols;
+    std::vector<char> revealed;
+    std::vector<char> knownMine;
+    std::vector<char> queued;
+    std::vector<int> pending;
+    std::vector<int> stack;
+    std::vector<int> unknownA, unknownB, onlyA, onlyB, shared;
+    int remaining = 0;
+
+    // Queues the revealed numbered cells around index, index included
+    void touch(int index) {
+        int ci = index / numCols;
+        int cj = index % numCols;
+        for (int di = -1; di <= 1; ++di) {
+            for (int dj = -1; dj <= 1; ++dj) {
+                int ni = ci + di;
+                int nj = cj + dj;
+                if (ni < 0 || ni >= numRows || nj < 0 || nj >= numCols)
+                    continue;
+                int neighbor = ni * numCols + nj;
+                if (revealed[neighbor] && board[neighbor] != 0 &&
+                    !queued[neighbor]) {
+                    queued[neighbor] = 1;
+                    pending.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // Reveals a cell, opening the surrounding region if it is a zero
+    void reveal(int index) {
+        stack.push_back(index);
+        while (!stack.empty()) {
+            int current = stack.back();
+            stack.pop_back();
+            if (revealed[current]) continue;
+            revealed[current] = 1;
+            remaining--;
+            touch(current);
+            if (board[current] != 0) continue;
+            int ci = current / numCols;
+            int cj = current % numCols;
+            for (int di = -1; di <= 1; ++di) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int ni = ci + di;
+                    int nj = cj + dj;
+                    if (ni >= 0 && ni < numRows && nj >= 0 && nj < numCols &&
+                        !revealed[ni * numCols + nj]) {
+                        stack.push_back(ni * numCols + nj);
+                    }
+                }
+            }
+        }
+    }
+
+    // Collects the unknown neighbors of a revealed numbered cell and returns
+    // the number of mines it still has to place among them
+    int collectUnknown(int index, std::vector<int> &unknown) const {
+        int ci = index / numCols;
+        int cj = index % numCols;
+        int mineCount = 0;
+        unknown.clear();
+        for (int di = -1; di <= 1; ++di) {
+            for (int dj = -1; dj <= 1; ++dj) {
+                int ni = ci + di;
+                int nj = cj + dj;
+                if (ni < 0 || ni >= numRows || nj < 0 || nj >= numCols)
+                    continue;
+                int neighbor = ni * numCols + nj;
+                if (revealed[neighbor]) continue;
+                if (knownMine[neighbor]) {
+                    mineCount++;
+                } else {
+                    unknown.push_back(neighbor);
+                }
+            }
+        }
+        return board[index] - mineCount;
+    }
+
+    bool isAdjacent(int a, int b) const {
+        return std::abs(a / numCols - b / numCols) <= 1 &&
+               std::abs(a % numCols - b % numCols) <= 1;
+    }
+
+    // Reveals or marks the still unknown cells of a group
+    bool apply(const std::vector<int> &group, bool safe, bool mine) {
+        if (!safe && !mine) return false;
+        bool changed = false;
+        for (int cell : group) {
+            if (revealed[cell] || knownMine[cell]) continue;
+            if (safe) {
+                reveal(cell);
+            } else {
+                knownMine[cell] = 1;
+                touch(cell);
+            }
+            changed = true;
+        }
+        return changed;
+    }
+
+    // Applies the pattern table to a revealed numbered cell, first on its own
+    // and then paired with each numbered cell up to two steps away, the same
+    // deductions updatePatternCells makes for the hint. Stops at the first
+    // change; the changed cells queue this one again.
+    void deduce(int index) {
+        int minesA = collectUnknown(index, unknownA);
+        if (unknownA.empty() || minesA < 0) return;
+        unsigned char single =
+            lookupPattern(unknownA.size(), 0, 0, minesA, 0);
+        if (apply(unknownA, single & kOnlyASafe, single & kOnlyAMine)) return;
+
+        int ci = index / numCols;
+        int cj = index % numCols;
+        for (int dr = -2; dr <= 2; ++dr) {
+            for (int dc = -2; dc <= 2; ++dc) {
+                int bi = ci + dr;
+                int bj = cj + dc;
+                if ((dr == 0 && dc == 0) || bi < 0 || bi >= numRows ||
+                    bj < 0 || bj >= numCols)
+                    continue;
+                int b = bi * numCols + bj;
+                if (!revealed[b] || board[b] == 0) continue;
+                int minesB = collectUnknown(b, unknownB);
+                if (unknownB.empty() || minesB < 0) continue;
+
+                onlyA.clear();
+                onlyB.clear();
+                shared.clear();
+                for (int cell : unknownA) {
+                    (isAdjacent(cell, b) ? shared : onlyA).push_back(cell);
+                }
+                for (int cell : unknownB) {
+                    if (!isAdjacent(cell, index)) onlyB.push_back(cell);
+                }
+                unsigned char deduction =
+                    lookupPattern(onlyA.size(), onlyB.size(), shared.size(),
+                                  minesA, minesB);
+                bool changed =
+                    apply(onlyA, deduction & kOnlyASafe,
+                          deduction & kOnlyAMine);
+                changed |= apply(onlyB, deduction & kOnlyBSafe,
+                                 deduction & kOnlyBMine);
+                changed |= apply(shared, deduction & kSharedSafe,
+                                 deduction & kSharedMine);
+                if (changed) return;
+            }
+        }
+    }
+};
+
+/*
+ * Plays the board with the same pattern table as the hint algorithm
+ * (updatePatternCells) and counts how often the player is stuck. The first
+ * click goes to the first opening, and every guess picks the first hidden safe
+ * cell in row-major order, preferring a zero. The first click is not counted.
+ */
+static uint32_t countRequiredGuesses(const std::vector<unsigned char> &board,
+                                     int numRows, int numCols) {
+    GuessSimulation game(board, numRows, numCols);
+    int numCells = numRows * numCols;
+    for (int index = 0; index < numCells; ++index) {
+        if (board[index] != kMineCell) game.remaining++;
+    }
+
+    // Revealed cells stay revealed, so both guess cursors only move forward
+    int zeroCursor = 0;
+    int safeCursor = 0;
+    uint32_t guesses = 0;
+    bool firstClick = true;
+    while (game.remaining > 0) {
+        while (zeroCursor < numCells &&
+               (game.revealed[zeroCursor] || board[zeroCursor] != 0))
+            zeroCursor++;
+        while (safeCursor < numCells && (game.revealed[safeCursor] ||
+                                         board[safeCursor] == kMineCell))
+            safeCursor++;
+        if (!firstClick) guesses++;
+        firstClick = false;
+        game.reveal(zeroCursor < numCells ? zeroCursor : safeCursor);
+
+        while (!game.pending.empty() && game.remaining > 0) {
+            int index = game.pending.back();
+            game.pending.pop_back();
+            game.queued[index] = 0;
+            game.deduce(index);
+        }
+    }
+    return guesses;
+}
+
+/*
+ * Generates a board the same way placeMines and setNumbers do for the widget
+ * grid, but into the flat encoding and from a fixed seed so that any board of
+ * a batch can be regenerated later.
+ */
+std::vector<unsigned char> generateBoard(int numRows, int numCols,
+                                         int numMines, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> pick(0, numRows * numCols - 1);
+    std::vector<unsigned char> board(numRows * numCols, 0);
+    int placedMines = 0;
+    while (placedMines < numMines) {
+        int index = pick(rng);
+        if (board[index] != kMineCell) {
+            board[index] = kMineCell;
+            placedMines++;
+        }
+    }
+
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            if (board[i * numCols + j] == kMineCell) continue;
+            int mineCount = 0;
+            for (int di = -1; di <= 1; ++di) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int ni = i + di;
+                    int nj = j + dj;
+                    if (ni >= 0 && ni < numRows && nj >= 0 && nj < numCols &&
+                        board[ni * numCols + nj] == kMineCell) {
+                        mineCount++;
+                    }
+                }
+            }
+            board[i * numCols + j] = mineCount;
+        }
+    }
+    return board;
+}
+
+/*
+ * Computes the difficulty metrics of a board. Zero cells are merged into
+ * openings with union-find; every opening costs one click, as does every
+ * numbered cell that no opening reveals, which together gives the 3BV.
+ */
+BoardMetrics analyzeBoard(const std::vector<unsigned char> &board,
+                          int numRows, int numCols) {
+    int numCells = numRows * numCols;
+    std::vector<int> parent(numCells);
+    for (int index = 0; index < numCells; ++index) {
+        parent[index] = index;
+    }
+
+    // Union each zero cell with the zero cells after it in row-major order
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            int index = i * numCols + j;
+            if (board[index] != 0) continue;
+            if (j + 1 < numCols && board[index + 1] == 0)
+                unite(parent, index, index + 1);
+            if (i + 1 < numRows) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int nj = j + dj;
+                    if (nj >= 0 && nj < numCols &&
+                        board[index + numCols + dj] == 0)
+                        unite(parent, index, index + numCols + dj);
+                }
+            }
+        }
+    }
+
+    BoardMetrics metrics = {0, 0, 0, 0};
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            int index = i * numCols + j;
+            if (board[index] == 0) {
+                if (findRoot(parent, index) == index) metrics.openings++;
+                continue;
+            }
+            if (board[index] == kMineCell) continue;
+
+            bool bordersOpening = false;
+            for (int di = -1; di <= 1 && !bordersOpening; ++di) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int ni = i + di;
+                    int nj = j + dj;
+                    if (ni >= 0 && ni < numRows && nj >= 0 && nj < numCols &&
+                        board[ni * numCols + nj] == 0) {
+                        bordersOpening = true;
+                        break;
+                    }
+                }
+            }
+            if (!bordersOpening) metrics.isolatedNumbers++;
+        }
+    }
+    metrics.bbbv = metrics.openings + metrics.isolatedNumbers;
+    metrics.requiredGuesses = countRequiredGuesses(board, numRows, numCols);
+    return metrics;
+}
+
+/*
+ * Generates and analyzes numBoards boards across numThreads workers (0 uses
+ * every core). Board k is generated from seed + k, so the results do not
+ * depend on the number of threads.
+ */
+std::vector<BoardMetrics> analyzeBatch(int numBoards, int numRows, int numCols,
+                                       int numMines, uint64_t seed,
+                                       unsigned numThreads) {
+    numThreads = resolveThreadCount(numThreads);
+    std::vector<BoardMetrics> metrics(std::max(numBoards, 0));
+    std::atomic<int> nextChunk{0};
+
+    auto worker = [&]() {
+        for (;;) {
+            int begin = nextChunk.fetch_add(kBatchChunkSize);
+            if (begin >= numBoards) return;
+            int end = std::min(begin + kBatchChunkSize, numBoards);
+            for (int k = begin; k < end; ++k) {
+                std::vector<unsigned char> board =
+                    generateBoard(numRows, numCols, numMines, seed + k);
+                metrics[k] = analyzeBoard(board, numRows, numCols);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < numThreads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : workers) {
+        thread.join();
+    }
+    return metrics;
+}
+
+// Writes the low numBytes bytes of value, least significant byte first
+static void writeLittleEndian(std::ofstream &out, uint64_t value,
+                              int numBytes) {
+    char bytes[8];
+    for (int i = 0; i < numBytes; ++i) {
+        bytes[i] = char(value >> (8 * i));
+    }
+    out.write(bytes, numBytes);
+}
+
+/*
+ * Writes batch metrics as a little-endian columnar file: a header
+ * ("MSBA", version, rows, cols, mines as uint32, then seed and board count as
+ * uint64) followed by one uint32 column per metric in BoardMetrics order.
+ * Values are converted explicitly, so the file is the same on any host.
+ * Returns false if the file could not be written.
+ */
+bool writeMetricsColumns(const std::string &path,
+                         const std::vector<BoardMetrics> &metrics,
+                         int numRows, int numCols, int numMines,
+                         uint64_t seed) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out.write("MSBA", 4);
+    writeLittleEndian(out, 1, 4);
+    writeLittleEndian(out, uint32_t(numRows), 4);
+    writeLittleEndian(out, uint32_t(numCols), 4);
+    writeLittleEndian(out, uint32_t(numMines), 4);
+    writeLittleEndian(out, seed, 8);
+    writeLittleEndian(out, metrics.size(), 8);
+
+    uint32_t BoardMetrics::*columns[] = {
+        &BoardMetrics::bbbv, &BoardMetrics::openings,
+        &BoardMetrics::isolatedNumbers, &BoardMetrics::requiredGuesses};
+    std::vector<char> column(metrics.size() * 4);
+    for (uint32_t BoardMetrics::*field : columns) {
+        for (size_t k = 0; k < metrics.size(); ++k) {
+            uint32_t value = metrics[k].*field;
+            for (int i = 0; i < 4; ++i) {
+                column[k * 4 + i] = char(value >> (8 * i));
+            }
+        }
+        out.write(column.data(), column.size());
+    }
+    return bool(out);
+}
@@ -0,0 +1,28 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Difficulty metrics of a single board in the flat encoding of floodfill.h.
+struct BoardMetrics {
+    uint32_t bbbv;             // 3BV: minimum clicks needed to clear the board
+    uint32_t openings;         // Connected regions of zero cells
+    uint32_t isolatedNumbers;  // Numbered cells not bordering any opening
+    uint32_t requiredGuesses;  // Guesses after the first click (see .cpp)
+};
+
+std::vector<unsigned char> generateBoard(int numRows, int numCols,
+                                         int numMines, uint64_t seed);
+BoardMetrics analyzeBoard(const std::vector<unsigned char> &board,
+                          int numRows, int numCols);
+std::vector<BoardMetrics> analyzeBatch(int numBoards, int numRows, int numCols,
+                                       int numMines, uint64_t seed,
+                                       unsigned numThreads = 0);
+bool writeMetricsColumns(const std::string &path,
+                         const std::vector<BoardMetrics> &metrics,
+                         int numRows, int numCols, int numMines,
+                         uint64_t seed);
+
+#endif  // ANALYTICS_H
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../board.h"
+#include "../floodfill.h"
+
+/*
+ * Times floodFillSerial against floodFillParallel on one large opening.
+ * Usage: floodfill_bench [rows] [cols] [mineDensity] [maxThreads]
+ */
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+int main(int argc, char *argv[]) {
+    int numRows = argc > 1 ? atoi(argv[1]) : 4000;
+    int numCols = argc > 2 ? atoi(argv[2]) : 4000;
+    double density = argc > 3 ? atof(argv[3]) : 0.01;
+    unsigned maxThreads =
+        argc > 4 ? atoi(argv[4]) : std::thread::hardware_concurrency();
+
+    std::mt19937_64 rng(1);
+    std::bernoulli_distribution isMine(density);
+    std::vector<unsigned char> board(size_t(numRows) * numCols, 0);
+    for (unsigned char &value : board) {
+        value = isMine(rng) ? kMineCell : 0;
+    }
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            if (board[i * numCols + j] == kMineCell) continue;
+            int mineCount = 0;
+            for (int di = -1; di <= 1; ++di) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int ni = i + di;
+                    int nj = j + dj;
+                    if (ni >= 0 && ni < numRows && nj >= 0 && nj < numCols &&
+                        board[ni * numCols + nj] == kMineCell)
+                        mineCount++;
+                }
+            }
+            board[i * numCols + j] = mineCount;
+        }
+    }
+
+    // Start from the zero cell closest to the center
+    int start = numRows / 2 * numCols + numCols / 2;
+    while (start < int(board.size()) && board[start] != 0) start++;
+    int row = start / numCols;
+    int col = start % numCols;
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<int> serial =
+        floodFillSerial(board, numRows, numCols, row, col);
+    double serialTime = secondsSince(begin);
+    printf("%dx%d density %.3f, %zu cells opened, %u hardware threads\n",
+           numRows, numCols, density, serial.size(),
+           std::thread::hardware_concurrency());
+    printf("serial      %8.3f s\n", serialTime);
+
+    for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        begin = std::chrono::steady_clock::now();
+        std::vector<int> parallel =
+            floodFillParallel(board, numRows, numCols, row, col, numThreads);
+        double time = secondsSince(begin);
+        printf("%2u threads  %8.3f s  speedup %.2fx  %s\n", numThreads, time,
+               serialTime / time, parallel == serial ? "match" : "MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+SOURCES += \
+    floodfill_bench.cpp \
+    ../floodfill.cpp
+
+HEADERS += \
+    ../board.h \
+    ../floodfill.h \
+    ../workers.h
+
+QT -= core gui
+CONFIG += console c++17 thread
+CONFIG -= app_bundle
+
+TARGET = floodfill_bench
+TEMPLATE = app
@@ -0,0 +1,12 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+/*
+ * Flat, row-major board encoding used by the non-widget algorithms.
+ * Values 0-8 are the number of adjacent mines, kMineCell marks a mine and
+ * kRevealedCell marks a cell that is already open and must not be opened again.
+ */
+const unsigned char kMineCell = 9;
+const unsigned char kRevealedCell = 0xFF;
+
+#endif  // BOARD_H
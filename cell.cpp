@@ -1,25 +1,22 @@
 #include <QMessageBox>
 #include <QPixmap>
 
+#include "board.h"
 #include "cell.h"
+#include "floodfill.h"
 
-Cell::Cell(int row, int col, int numRows, int numCols, Cell *(**cells),
-           bool &gameOver,
-           void (*lockAllCells)(Cell ***cells, int numRows, int numCols),
-           void (*openAllMines)(Cell ***cells, int numRows, int numCols),
-           QWidget *parent)
+Cell::Cell(int row, int col, BoardContext &board, QWidget *parent)
     : QWidget(parent),
+    board(board),
+    row(row),
+    col(col),
     mode(Empty),
-    cells(cells),
+    safe(false),
     guaranteedMine(false),
     revealed(false),
-    gameOver(gameOver),
-    numRows(numRows),
-    numCols(numCols),
-    row(row),
-    col(col),
-    lockAllCells(lockAllCells),
-    openAllMines(openAllMines) {
+    flagged(false),
+    hint(false),
+    willRevealIfNotRevealed(false) {
     imageLabel = new QLabel(this);
 }
 
@@ -47,23 +44,25 @@ void Cell::mousePressEvent(QMouseEvent *event) {
 
     if (event->button() == Qt::LeftButton) {
         if (mode == Mine) {
-            gameOver = true;  // Set game state to over
+            board.gameOver = true;  // Set game state to over
             if (hintButton) {
                 hintButton->setEnabled(false);  // Disable the hint button
             }
-            openAllMines(cells, numRows, numCols);  // Open all mines
+            board.openAllMines(board.cells, board.numRows,
+                               board.numCols);  // Open all mines
             QMessageBox::information(this, "Game Over",
                                      "You Lost!");  // Show "You Lost" message
-            lockAllCells(cells, numRows, numCols);  // Lock all cells
+            board.lockAllCells(board.cells, board.numRows,
+                               board.numCols);  // Lock all cells
         } else {
             reveal();  // Proceed with normal revealing logic
         }
     }
 
     if (event->button() == Qt::RightButton) {
-        if (!isEnabled() || revealed ||
-            gameOver)  // If cell is already locked, revealed, or game is over,
-            // ignore the click
+        // If cell is already locked, revealed, or game is over, ignore the
+        // click
+        if (!isEnabled() || revealed || board.gameOver)
             return;
         if (!isFlagged()) {
             showFlag();
@@ -165,23 +164,24 @@ void Cell::increaseCount() {
  * shown.
  */
 void Cell::checkWinCondition() {
-    for (int i = 0; i < numRows; ++i) {
-        for (int j = 0; j < numCols; ++j) {
-            if (!cells[i][j]->isRevealed() && !cells[i][j]->hasMine()) {
+    for (int i = 0; i < board.numRows; ++i) {
+        for (int j = 0; j < board.numCols; ++j) {
+            if (!board.cells[i][j]->isRevealed() &&
+                !board.cells[i][j]->hasMine()) {
                 return;  // If there are still non-mine cells that are not
                     // revealed, return
             }
         }
     }
 
-    if (!gameOver) {
-        gameOver = true;
+    if (!board.gameOver) {
+        board.gameOver = true;
         if (hintButton) {
             hintButton->setEnabled(false);
         }
-        openAllMines(cells, numRows, numCols);
+        board.openAllMines(board.cells, board.numRows, board.numCols);
         QMessageBox::information(this, "Game Won", "Congratulations, you won!");
-        lockAllCells(cells, numRows, numCols);
+        board.lockAllCells(board.cells, board.numRows, board.numCols);
     }
 }
 
@@ -194,9 +194,7 @@ void Cell::reveal() {
     if (revealed) {
         return;  // Do not reveal if already revealed
     }
-    revealed = true;
-    updateImage();
-    emit clicked();  // Emit the clicked signal
+    open();
 
     if (mode == Empty || mode == Num0) {
         revealEmptyNeighbors(row, col);
@@ -205,6 +203,26 @@ void Cell::reveal() {
     checkWinCondition();  // Check if the player has won after revealing a cell
 }
 
+/*
+ * Marks the cell as revealed without cascading to its neighbors or checking
+ * the win condition.
+ */
+void Cell::open() {
+    revealed = true;
+    updateImage();
+    emit clicked();  // Emit the clicked signal
+}
+
+/*
+ * Returns the cell's value in the flat board encoding used by floodFill.
+ */
+unsigned char Cell::boardValue() const {
+    if (revealed) return kRevealedCell;
+    if (mode == Empty) return 0;
+    if (mode >= Num0 && mode <= Num8) return mode - Num0;
+    return kMineCell;
+}
+
 /*
  * Locks the cell, disabling mouse events and changing the cursor.
  */
@@ -230,19 +248,23 @@ void Cell::resetCell() {
 }
 
 /*
- * Reveals all neighboring cells that are not yet revealed.
- * This function is called recursively for empty cells to reveal large empty
- * areas.
+ * Reveals all cells connected to the empty cell at (row, col) through other
+ * empty cells, together with their numbered border. The board is snapshotted
+ * into a flat array and handed to floodFill, which switches to the parallel
+ * path on large boards; the widgets are then opened in row-major order.
  */
 void Cell::revealEmptyNeighbors(int row, int col) {
-    for (int di = -1; di <= 1; ++di) {
-        for (int dj = -1; dj <= 1; ++dj) {
-            int ni = row + di;
-            int nj = col + dj;
-            if (ni >= 0 && ni < numRows && nj >= 0 && nj < numCols &&
-                !cells[ni][nj]->isRevealed()) {
-                cells[ni][nj]->reveal();
-            }
+    int numRows = board.numRows;
+    int numCols = board.numCols;
+    Cell ***cells = board.cells;
+    std::vector<unsigned char> values(numRows * numCols);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            values[i * numCols + j] = cells[i][j]->boardValue();
         }
     }
+
+    for (int index : floodFill(values, numRows, numCols, row, col)) {
+        cells[index / numCols][index % numCols]->open();
+    }
 }
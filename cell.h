@@ -6,17 +6,30 @@
 #include <QPushButton>
 #include <QWidget>
 
+class Cell;
+
+/*
+ * State shared by every cell of a board. One instance lives as long as the
+ * board and each cell references it instead of keeping its own copies.
+ */
+struct BoardContext {
+    Cell ***cells;
+    int numRows;
+    int numCols;
+    bool gameOver;
+    void (*lockAllCells)(Cell ***cells, int numRows, int numCols);
+    void (*openAllMines)(Cell ***cells, int numRows, int numCols);
+};
+
 class Cell : public QWidget {
     Q_OBJECT
-    bool willRevealIfNotRevealed = false;
-    bool hint = false;
 
 signals:
     void clicked();
     void rightClicked();
 
 public:
-    enum Mode {
+    enum Mode : unsigned char {
         Empty,
         Flag,
         Mine,
@@ -37,10 +50,7 @@ public:
 
     static void setHintButton(QPushButton *button);
 
-    explicit Cell(int row, int col, int numRows, int numCols, Cell *(**cells),
-                  bool &gameOver,
-                  void (*lockAllCells)(Cell ***cells, int numRows, int numCols),
-                  void (*openAllMines)(Cell ***cells, int numRows, int numCols),
+    explicit Cell(int row, int col, BoardContext &board,
                   QWidget *parent = nullptr);
     void setMode(Mode newMode);
 
@@ -81,27 +91,27 @@ protected:
 
 private:
     static QPushButton *hintButton;  // Add this line
-    Mode mode;
     QLabel *imageLabel;
-    Cell *(**cells);
+    BoardContext &board;  // Shared by all cells of the board
 
-    bool safe;
-    bool guaranteedMine;
-    bool revealed;
-    bool flagged;
-    bool &gameOver;
-
-    int numRows;
-    int numCols;
     int row;
     int col;
+    Mode mode;
+
+    // Per-cell state packed into a single byte
+    bool safe : 1;
+    bool guaranteedMine : 1;
+    bool revealed : 1;
+    bool flagged : 1;
+    bool hint : 1;
+    bool willRevealIfNotRevealed : 1;
 
     void checkWinCondition();
     void updateImage();
+    void open();
+    unsigned char boardValue() const;
     void revealEmptyNeighbors(int row, int col);
     void handleRightClick();  // Method to handle right-click events
-    void (*lockAllCells)(Cell ***cells, int numRows, int numCols);
-    void (*openAllMines)(Cell ***cells, int numRows, int numCols);
 };
 
 #endif  // CELL_H
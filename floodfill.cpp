@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "floodfill.h"
+#include "workers.h"
+
+// Smallest private stack a worker splits to feed idle workers.
+static const size_t kMinShareSize = 64;
+
+/*
+ * Work queue a worker shares with the others. The owner moves the oldest half
+ * of its private stack here while some worker is idle, and idle workers steal
+ * from the front of it.
+ */
+struct alignas(64) FloodFillQueue {
+    std::mutex mutex;
+    std::deque<int> cells;
+    std::atomic<bool> empty{true};  // Lock-free hint for the owner
+};
+
+/*
+ * State shared by all workers of one parallel flood fill. The visited bitmap
+ * packs 64 cells per word and is claimed with fetch_or, so each cell is
+ * opened by exactly one worker.
+ */
+struct FloodFillState {
+    FloodFillState(const std::vector<unsigned char> &board, int numRows,
+                   int numCols, unsigned numThreads)
+        : board(board),
+        numRows(numRows),
+        numCols(numCols),
+        numThreads(numThreads),
+        visited((board.size() + 63) / 64),
+        queues(numThreads) {}
+
+    const std::vector<unsigned char> &board;
+    int numRows;
+    int numCols;
+    unsigned numThreads;
+    std::vector<std::atomic<uint64_t>> visited;
+    std::vector<FloodFillQueue> queues;
+    std::atomic<unsigned> idle{0};
+
+    bool claim(int index) {
+        std::atomic<uint64_t> &word = visited[index >> 6];
+        uint64_t bit = uint64_t(1) << (index & 63);
+        // Plain load first: most neighbors are already claimed
+        if (word.load(std::memory_order_relaxed) & bit) return false;
+        return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+};
+
+/*
+ * Moves the oldest half of a worker's stack to its shared queue.
+ */
+static void shareWork(FloodFillState &state, unsigned worker,
+                      std::vector<int> &stack) {
+    size_t half = stack.size() / 2;
+    FloodFillQueue &queue = state.queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.cells.insert(queue.cells.end(), stack.begin(), stack.begin() + half);
+    queue.empty.store(false, std::memory_order_relaxed);
+    stack.erase(stack.begin(), stack.begin() + half);
+}
+
+/*
+ * Refills an empty stack from the worker's own queue, or else steals half of
+ * another worker's queue. Returns false once every worker is idle, which can
+ * only happen when all queues are empty: a worker goes idle with an empty
+ * queue, and only the owner adds to a queue.
+ */
+static bool takeWork(FloodFillState &state, unsigned worker,
+                     std::vector<int> &stack) {
+    FloodFillQueue &own = state.queues[worker];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.cells.empty()) {
+            stack.assign(own.cells.begin(), own.cells.end());
+            own.cells.clear();
+            own.empty.store(true, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    state.idle.fetch_add(1);
+    for (;;) {
+        for (unsigned k = 1; k < state.numThreads; ++k) {
+            FloodFillQueue &victim =
+                state.queues[(worker + k) % state.numThreads];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.cells.empty()) continue;
+
+            // Leave the idle count before taking anything
+            state.idle.fetch_sub(1);
+            size_t count = (victim.cells.size() + 1) / 2;
+            stack.assign(victim.cells.begin(), victim.cells.begin() + count);
+            victim.cells.erase(victim.cells.begin(),
+                               victim.cells.begin() + count);
+            victim.empty.store(victim.cells.empty(),
+                               std::memory_order_relaxed);
+            return true;
+        }
+        if (state.idle.load() == state.numThreads) return false;
+        std::this_thread::yield();
+    }
+}
+
+/*
+ * Expands cells depth-first from a private stack. Newly claimed zero cells are
+ * pushed for expansion; numbered cells only need their visited bit.
+ */
+static void floodFillWorker(FloodFillState &state, unsigned worker,
+                            int start) {
+    std::vector<int> stack;
+    if (start >= 0) stack.push_back(start);
+    for (;;) {
+        if (stack.empty() && !takeWork(state, worker, stack)) return;
+        int current = stack.back();
+        stack.pop_back();
+        int row = current / state.numCols;
+        int col = current % state.numCols;
+        for (int di = -1; di <= 1; ++di) {
+            for (int dj = -1; dj <= 1; ++dj) {
+                int ni = row + di;
+                int nj = col + dj;
+                if (ni < 0 || ni >= state.numRows || nj < 0 ||
+                    nj >= state.numCols)
+                    continue;
+                int neighbor = ni * state.numCols + nj;
+                if (state.board[neighbor] != kRevealedCell &&
+                    state.claim(neighbor) && state.board[neighbor] == 0) {
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+        // Feed starving workers once the previous share has been taken
+        if (stack.size() >= kMinShareSize &&
+            state.idle.load(std::memory_order_relaxed) > 0 &&
+            state.queues[worker].empty.load(std::memory_order_relaxed)) {
+            shareWork(state, worker, stack);
+        }
+    }
+}
+
+/*
+ * Collects the opened cells of words [firstWord, lastWord) in row-major order.
+ */
+static void collectOpened(const FloodFillState &state, size_t firstWord,
+                          size_t lastWord, std::vector<int> &opened) {
+    for (size_t word = firstWord; word < lastWord; ++word) {
+        uint64_t bits = state.visited[word].load(std::memory_order_relaxed);
+        while (bits) {
+            int index = int(word * 64) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (state.board[index] != kRevealedCell) {
+                opened.push_back(index);
+            }
+        }
+    }
+}
+
+/*
+ * Returns the row-major indices of the cells opened by expanding the empty
+ * cell at (row, col): every cell reachable through zero cells, skipping cells
+ * marked kRevealedCell. The start cell is expanded whatever its value, so
+ * callers may pass a cell they have already revealed.
+ */
+std::vector<int> floodFillSerial(const std::vector<unsigned char> &board,
+                                 int numRows, int numCols, int row, int col) {
+    std::vector<char> visited(board.size(), 0);
+    std::vector<int> stack;
+    int start = row * numCols + col;
+    visited[start] = 1;
+    stack.push_back(start);
+    while (!stack.empty()) {
+        int current = stack.back();
+        stack.pop_back();
+        if (current != start && board[current] != 0) continue;
+        int ci = current / numCols;
+        int cj = current % numCols;
+        for (int di = -1; di <= 1; ++di) {
+            for (int dj = -1; dj <= 1; ++dj) {
+                int ni = ci + di;
+                int nj = cj + dj;
+                if (ni < 0 || ni >= numRows || nj < 0 || nj >= numCols)
+                    continue;
+                int neighbor = ni * numCols + nj;
+                if (!visited[neighbor] && board[neighbor] != kRevealedCell) {
+                    visited[neighbor] = 1;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    std::vector<int> opened;
+    for (int index = 0; index < int(board.size()); ++index) {
+        if (visited[index] && board[index] != kRevealedCell) {
+            opened.push_back(index);
+        }
+    }
+    return opened;
+}
+
+/*
+ * Same result as floodFillSerial, computed across numThreads workers (0 uses
+ * every core) that expand cells from private stacks and steal from each
+ * other's queues when they run dry. The opened set is the closure of the
+ * start cell, so the output does not depend on scheduling.
+ */
+std::vector<int> floodFillParallel(const std::vector<unsigned char> &board,
+                                   int numRows, int numCols, int row, int col,
+                                   unsigned numThreads) {
+    numThreads = resolveThreadCount(numThreads);
+    FloodFillState state(board, numRows, numCols, numThreads);
+    int start = row * numCols + col;
+    state.claim(start);
+
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < numThreads; ++worker) {
+        workers.emplace_back(floodFillWorker, std::ref(state), worker, -1);
+    }
+    floodFillWorker(state, 0, start);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    // Gather the bitmap in row-major slices so the output order is fixed
+    size_t numWords = state.visited.size();
+    std::vector<std::vector<int>> slices(numThreads);
+    workers.clear();
+    for (unsigned worker = 1; worker < numThreads; ++worker) {
+        workers.emplace_back([&state, &slices, numWords, numThreads, worker] {
+            collectOpened(state, numWords * worker / numThreads,
+                          numWords * (worker + 1) / numThreads, slices[worker]);
+        });
+    }
+    collectOpened(state, 0, numWords / numThreads, slices[0]);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    std::vector<int> opened = std::move(slices[0]);
+    for (unsigned worker = 1; worker < numThreads; ++worker) {
+        opened.insert(opened.end(), slices[worker].begin(),
+                      slices[worker].end());
+    }
+    return opened;
+}
+
+/*
+ * Picks the serial or parallel flood fill. The serial path is used on small
+ * boards and whenever only one core is available, where the parallel path
+ * would pay for the atomic bitmap and the threads without any gain.
+ */
+std::vector<int> floodFill(const std::vector<unsigned char> &board,
+                           int numRows, int numCols, int row, int col) {
+    unsigned numThreads = resolveThreadCount(0);
+    if (numThreads == 1 || numRows * numCols < kParallelFloodFillThreshold) {
+        return floodFillSerial(board, numRows, numCols, row, col);
+    }
+    return floodFillParallel(board, numRows, numCols, row, col, numThreads);
+}
@@ -0,0 +1,19 @@
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+#include <vector>
+
+#include "board.h"
+
+// Boards with fewer cells than this are always filled on the calling thread.
+const int kParallelFloodFillThreshold = 1 << 16;
+
+std::vector<int> floodFillSerial(const std::vector<unsigned char> &board,
+                                 int numRows, int numCols, int row, int col);
+std::vector<int> floodFillParallel(const std::vector<unsigned char> &board,
+                                   int numRows, int numCols, int row, int col,
+                                   unsigned numThreads = 0);
+std::vector<int> floodFill(const std::vector<unsigned char> &board,
+                           int numRows, int numCols, int row, int col);
+
+#endif  // FLOODFILL_H
@@ -6,6 +6,14 @@
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "analytics.h"
 #include "cell.h"
 #include "utils.h"
 
@@ -21,10 +29,59 @@ const int paddingX = 20;
 const int paddingY = 64;
 
 // State Variables
-bool gameOver = false;
 int score = 0;  // Initialize score variable
 
+/*
+ * Parses a whole decimal argument within [min, max].
+ */
+static bool parseArgument(const char *text, unsigned long long min,
+                          unsigned long long max, unsigned long long &value) {
+    if (!*text || *text == '-') return false;
+    char *end;
+    errno = 0;
+    value = strtoull(text, &end, 10);
+    return errno == 0 && *end == '\0' && value >= min && value <= max;
+}
+
+/*
+ * Batch analytics mode:
+ * minesweeper --analyze <numBoards> <rows> <cols> <mines> <outputFile> [seed]
+ * Board k of the batch is generated from seed + k; the seed defaults to the
+ * current time and is stored in the output file.
+ */
+static int runAnalytics(int argc, char *argv[]) {
+    unsigned long long numBoards, rows, cols, mines;
+    unsigned long long seed = time(nullptr);
+    bool valid = (argc == 7 || argc == 8) &&
+                 parseArgument(argv[2], 1, INT_MAX, numBoards) &&
+                 parseArgument(argv[3], 1, 65535, rows) &&
+                 parseArgument(argv[4], 1, 65535, cols) &&
+                 rows * cols <= INT_MAX &&
+                 parseArgument(argv[5], 0, rows * cols - 1, mines) &&
+                 (argc == 7 || parseArgument(argv[7], 0, ULLONG_MAX, seed));
+    if (!valid) {
+        fprintf(stderr,
+                "Usage: %s --analyze <numBoards> <rows> <cols> <mines> "
+                "<outputFile> [seed]\n"
+                "  mines must be smaller than rows * cols\n",
+                argv[0]);
+        return 2;
+    }
+
+    std::vector<BoardMetrics> metrics =
+        analyzeBatch(numBoards, rows, cols, mines, seed);
+    if (!writeMetricsColumns(argv[6], metrics, rows, cols, mines, seed)) {
+        fprintf(stderr, "Could not write %s\n", argv[6]);
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--analyze") == 0) {
+        return runAnalytics(argc, argv);
+    }
+
     // Global application-level configuration
     QApplication app(argc, argv);
     QWidget mainWindow;
@@ -78,12 +135,12 @@ int main(int argc, char *argv[]) {
     for (int i = 0; i < N; ++i) {
         cells[i] = new Cell *[M];
     }
+    BoardContext board = {cells, N, M, false, lockAllCells, openAllMines};
 
     // Create and add cells to the grid layout
     for (int i = 0; i < N; ++i) {
         for (int j = 0; j < M; ++j) {
-            cells[i][j] = new Cell(i, j, N, M, cells, gameOver, lockAllCells,
-                                   openAllMines);
+            cells[i][j] = new Cell(i, j, board);
             cells[i][j]->setMode(Cell::Empty);
             gridLayout->addWidget(cells[i][j], i, j);
             QObject::connect(cells[i][j], &Cell::clicked, [&scoreLabel]() {
@@ -98,7 +155,7 @@ int main(int argc, char *argv[]) {
     // Connect the restart button's clicked signal to a slot to restart the game
     QObject::connect(
         restartButton, &QPushButton::clicked,
-        [&cells, &scoreLabel, &hintButton]() {
+        [&cells, &board, &scoreLabel, &hintButton]() {
             for (int i = 0; i < N; ++i) {
                 for (int j = 0; j < M; ++j) {
                     cells[i][j]->resetCell();  // Use the resetCell method
@@ -111,7 +168,7 @@ int main(int argc, char *argv[]) {
                 }
             }
             score = 0;
-            gameOver = false;
+            board.gameOver = false;
             scoreLabel->setText("Score: 0");
             hintButton->setEnabled(true);
             placeMines(cells, N, M, K);
@@ -1,6 +1,9 @@
 SOURCES += \
+    analytics.cpp \
     cell.cpp \
+    floodfill.cpp \
     main.cpp \
+    patterns.cpp \
     utils.cpp
 
 QT += core widgets gui
@@ -9,11 +12,17 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TARGET = minesweeper
 TEMPLATE = app
+CONFIG += c++17 thread
 
 
 HEADERS += \
+    analytics.h \
+    board.h \
     cell.h \
-    utils.h
+    floodfill.h \
+    patterns.h \
+    utils.h \
+    workers.h
 
 # Add the images folder to the resources
 RESOURCES += \
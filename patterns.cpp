@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <vector>
+
+#include "cell.h"
+#include "patterns.h"
+
+// Neighbor k of a cell sits at (row + kNeighborRow[k], col + kNeighborCol[k])
+static const int kNeighborRow[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+static const int kNeighborCol[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+
+// Every group size and mine count lies in 0-8
+static const int kPatternRange = 9;
+static const int kPatternTableSize =
+    kPatternRange * kPatternRange * kPatternRange * kPatternRange *
+    kPatternRange;
+
+/*
+ * Tables built once on first use. deductions is indexed by patternKey;
+ * overlap[dr + 2][dc + 2] holds the neighbor bits of a cell that are also
+ * neighbors of the cell (dr, dc) away from it.
+ */
+struct PatternTables {
+    std::vector<unsigned char> deductions;
+    unsigned char overlap[5][5];
+};
+
+static int patternKey(int onlyA, int onlyB, int shared, int minesA,
+                      int minesB) {
+    return (((onlyA * kPatternRange + onlyB) * kPatternRange + shared) *
+                kPatternRange +
+            minesA) *
+               kPatternRange +
+           minesB;
+}
+
+/*
+ * Two numbered cells A and B split their unknown neighbors into cells only A
+ * sees, cells only B sees and cells both see. Enumerates every way to divide
+ * A's and B's remaining mines over these groups and records which groups are
+ * all safe or all mines in every consistent split. Single-cell rules are the
+ * entries with an empty B, and patterns such as 1-1 against a wall, 1-2-1 and
+ * 1-2-2-1 reduce to these pairs.
+ */
+static PatternTables buildPatternTables() {
+    PatternTables tables;
+    tables.deductions.assign(kPatternTableSize, 0);
+    for (int onlyA = 0; onlyA < kPatternRange; ++onlyA) {
+        for (int onlyB = 0; onlyB < kPatternRange; ++onlyB) {
+            for (int shared = 0; shared < kPatternRange; ++shared) {
+                for (int minesA = 0; minesA < kPatternRange; ++minesA) {
+                    for (int minesB = 0; minesB < kPatternRange; ++minesB) {
+                        int minA = kPatternRange, maxA = -1;
+                        int minB = kPatternRange, maxB = -1;
+                        int minShared = kPatternRange, maxShared = -1;
+                        for (int s = 0; s <= shared; ++s) {
+                            int a = minesA - s;
+                            int b = minesB - s;
+                            if (a < 0 || a > onlyA || b < 0 || b > onlyB)
+                                continue;
+                            minA = std::min(minA, a);
+                            maxA = std::max(maxA, a);
+                            minB = std::min(minB, b);
+                            maxB = std::max(maxB, b);
+                            minShared = std::min(minShared, s);
+                            maxShared = std::max(maxShared, s);
+                        }
+                        if (maxShared < 0) continue;  // Inconsistent numbers
+
+                        unsigned char deduction = 0;
+                        if (onlyA > 0 && maxA == 0) deduction |= kOnlyASafe;
+                        if (onlyA > 0 && minA == onlyA)
+                            deduction |= kOnlyAMine;
+                        if (onlyB > 0 && maxB == 0) deduction |= kOnlyBSafe;
+                        if (onlyB > 0 && minB == onlyB)
+                            deduction |= kOnlyBMine;
+                        if (shared > 0 && maxShared == 0)
+                            deduction |= kSharedSafe;
+                        if (shared > 0 && minShared == shared)
+                            deduction |= kSharedMine;
+                        tables.deductions[patternKey(onlyA, onlyB, shared,
+                                                     minesA, minesB)] =
+                            deduction;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int dr = -2; dr <= 2; ++dr) {
+        for (int dc = -2; dc <= 2; ++dc) {
+            unsigned char mask = 0;
+            for (int k = 0; k < 8; ++k) {
+                int r = kNeighborRow[k] - dr;
+                int c = kNeighborCol[k] - dc;
+                if (r >= -1 && r <= 1 && c >= -1 && c <= 1 &&
+                    !(r == 0 && c == 0)) {
+                    mask |= 1 << k;
+                }
+            }
+            tables.overlap[dr + 2][dc + 2] = mask;
+        }
+    }
+    return tables;
+}
+
+static const PatternTables &patternTables() {
+    static const PatternTables tables = buildPatternTables();
+    return tables;
+}
+
+/*
+ * Returns the deduction bits for a pair of numbered cells, given the sizes of
+ * their unknown neighbor groups and the mines each still has to place.
+ */
+unsigned char lookupPattern(int onlyA, int onlyB, int shared, int minesA,
+                            int minesB) {
+    return patternTables()
+        .deductions[patternKey(onlyA, onlyB, shared, minesA, minesB)];
+}
+
+/*
+ * Marks the neighbors of (row, col) selected by mask as safe or as mines.
+ */
+static void markNeighbors(Cell ***cells, int row, int col, unsigned mask,
+                          bool safe, bool mine, bool &changed) {
+    if (!safe && !mine) return;
+    for (int k = 0; k < 8; ++k) {
+        if (!(mask & (1 << k))) continue;
+        Cell *neighbor = cells[row + kNeighborRow[k]][col + kNeighborCol[k]];
+        if (neighbor->isSafe() || neighbor->isGuaranteedMine()) continue;
+        if (safe) {
+            neighbor->setSafe(true);
+        } else {
+            neighbor->setGuaranteedMine(true);
+        }
+        changed = true;
+    }
+}
+
+/*
+ * Marks cells as safe or as mines for the hint algorithm. Each frontier cell is
+ * encoded as a bitmask of its unknown neighbors (hidden, not yet known safe or
+ * mine) and the number of mines it still has to place. The cell on its own and
+ * every pair it forms with a frontier cell up to two steps away are then
+ * resolved with one table lookup each.
+ */
+void updatePatternCells(Cell ***cells, int numRows, int numCols,
+                        bool &changed) {
+    const PatternTables &tables = patternTables();
+    changed = false;
+
+    std::vector<unsigned char> unknown(numRows * numCols, 0);
+    std::vector<int> mines(numRows * numCols, 0);
+    std::vector<int> frontier;
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numCols; ++j) {
+            Cell *cell = cells[i][j];
+            if (!cell->isRevealed() || cell->currentMode() < Cell::Num1 ||
+                cell->currentMode() > Cell::Num8)
+                continue;
+
+            unsigned char mask = 0;
+            int mineCount = 0;
+            for (int k = 0; k < 8; ++k) {
+                int ni = i + kNeighborRow[k];
+                int nj = j + kNeighborCol[k];
+                if (ni < 0 || ni >= numRows || nj < 0 || nj >= numCols)
+                    continue;
+                Cell *neighbor = cells[ni][nj];
+                if (neighbor->isRevealed()) continue;
+                if (neighbor->isGuaranteedMine()) {
+                    mineCount++;
+                } else if (!neighbor->isSafe()) {
+                    mask |= 1 << k;
+                }
+            }
+            int remaining = cell->currentMode() - Cell::Num0 - mineCount;
+            if (mask && remaining >= 0) {
+                unknown[i * numCols + j] = mask;
+                mines[i * numCols + j] = remaining;
+                frontier.push_back(i * numCols + j);
+            }
+        }
+    }
+
+    for (int a : frontier) {
+        int i = a / numCols;
+        int j = a % numCols;
+        unsigned maskA = unknown[a];
+        int sizeA = __builtin_popcount(maskA);
+
+        unsigned char single = lookupPattern(sizeA, 0, 0, mines[a], 0);
+        markNeighbors(cells, i, j, maskA, single & kOnlyASafe,
+                      single & kOnlyAMine, changed);
+
+        // Visit each pair once, from the cell that comes first row-major
+        for (int dr = 0; dr <= 2; ++dr) {
+            for (int dc = -2; dc <= 2; ++dc) {
+                if (dr == 0 && dc <= 0) continue;
+                int bi = i + dr;
+                int bj = j + dc;
+                if (bi >= numRows || bj < 0 || bj >= numCols) continue;
+                int b = bi * numCols + bj;
+                if (!unknown[b]) continue;
+
+                unsigned maskB = unknown[b];
+                unsigned overlapA = tables.overlap[dr + 2][dc + 2];
+                unsigned overlapB = tables.overlap[2 - dr][2 - dc];
+                int shared = __builtin_popcount(maskA & overlapA);
+                unsigned char deduction = lookupPattern(
+                    sizeA - shared, __builtin_popcount(maskB) - shared, shared,
+                    mines[a], mines[b]);
+                if (!deduction) continue;
+
+                markNeighbors(cells, i, j, maskA & ~overlapA,
+                              deduction & kOnlyASafe, deduction & kOnlyAMine,
+                              changed);
+                markNeighbors(cells, bi, bj, maskB & ~overlapB,
+                              deduction & kOnlyBSafe, deduction & kOnlyBMine,
+                              changed);
+                markNeighbors(cells, i, j, maskA & overlapA,
+                              deduction & kSharedSafe,
+                              deduction & kSharedMine, changed);
+            }
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+class Cell;
+
+// Deductions stored in the pattern table, one bit pair per group of cells
+const unsigned char kOnlyASafe = 1 << 0;
+const unsigned char kOnlyAMine = 1 << 1;
+const unsigned char kOnlyBSafe = 1 << 2;
+const unsigned char kOnlyBMine = 1 << 3;
+const unsigned char kSharedSafe = 1 << 4;
+const unsigned char kSharedMine = 1 << 5;
+
+unsigned char lookupPattern(int onlyA, int onlyB, int shared, int minesA,
+                            int minesB);
+void updatePatternCells(Cell ***cells, int numRows, int numCols,
+                        bool &changed);
+
+#endif  // PATTERNS_H
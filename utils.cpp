@@ -1,80 +1,16 @@
+#include "patterns.h"
 #include "utils.h"
 
-/*
- * Decides whether cells are guaranteed to be safe or mines from the perspective
- * of a user. Used in the hint algorithm. If the number of guaranteed mines
- * around a cell equals the cell's number, the remaining hidden cells around it
- * are marked as safe. If the number of guaranteed mines plus hidden cells
- * around a cell equals the cell's number, the remaining hidden cells are marked
- * as mines.
- */
-void updateSafeAndMineCells(Cell ***cells, int numRows, int numCols,
-                            bool &changed) {
-    changed = false;
-    for (int i = 0; i < numRows; ++i) {
-        for (int j = 0; j < numCols; ++j) {
-            Cell *cell = cells[i][j];
-            if (cell->isRevealed() && cell->currentMode() >= Cell::Num1 &&
-                cell->currentMode() <= Cell::Num8) {
-                int num = cell->currentMode() - Cell::Num0;
-
-                int mineCount = 0;
-                int hiddenCount = 0;
-                QVector<Cell *> neighbors;
-
-                for (int di = -1; di <= 1; ++di) {
-                    for (int dj = -1; dj <= 1; ++dj) {
-                        if (di == 0 && dj == 0)
-                            continue;  // Skip the cell itself
-                        int ni = i + di;
-                        int nj = j + dj;
-                        if (ni >= 0 && ni < numRows && nj >= 0 &&
-                            nj < numCols) {
-                            Cell *neighbor = cells[ni][nj];
-                            if (!neighbor->isRevealed()) {
-                                hiddenCount++;
-                                neighbors.append(neighbor);
-                                if (neighbor->isGuaranteedMine()) {
-                                    mineCount++;
-                                }
-                            }
-                        }
-                    }
-                }
-                if (mineCount == num) {
-                    for (Cell *neighbor : neighbors) {
-                        if (!neighbor->isGuaranteedMine() &&
-                            !neighbor->isSafe()) {
-                            neighbor->setSafe(true);
-                            changed = true;
-                        }
-                    }
-                }
-
-                if (mineCount + hiddenCount == num) {
-                    for (Cell *neighbor : neighbors) {
-                        if (!neighbor->isSafe() &&
-                            !neighbor->isGuaranteedMine()) {
-                            neighbor->setGuaranteedMine(true);
-                            changed = true;
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
 /*
  * Provides a hint to the player by identifying a safe cell that hasn't been
- * revealed. It updates the status of cells using the updateSafeAndMineCells
+ * revealed. It updates the status of cells using the updatePatternCells
  * function until no changes occur. If a safe cell is found, it is marked as a
  * hint. If no safe cells are available, a message is displayed.
  */
 void giveHint(Cell ***cells, int numRows, int numCols) {
     bool changed;
     do {
-        updateSafeAndMineCells(cells, numRows, numCols, changed);
+        updatePatternCells(cells, numRows, numCols, changed);
     } while (changed);
 
     static Cell *hintCell = nullptr;
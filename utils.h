@@ -11,8 +11,6 @@
 
 #include "cell.h"
 
-void updateSafeAndMineCells(Cell ***cells, int numRows, int numCols,
-                            bool &changed);
 void giveHint(Cell ***cells, int numRows, int numCols);
 void lockAllCells(Cell ***cells, int numRows, int numCols);
 void placeMines(Cell ***cells, int numRows, int numCols, int numMines);
@@ -0,0 +1,17 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <algorithm>
+#include <thread>
+
+/*
+ * Resolves a requested number of worker threads; 0 means one per core.
+ */
+inline unsigned resolveThreadCount(unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return numThreads;
+}
+
+#endif  // WORKERS_H